@@ -11,11 +11,15 @@ CONFIG += c++17
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
+    paintbench.cpp \
     pixelcanvas.cpp
 
 HEADERS += \
     mainwindow.h \
-    pixelcanvas.h
+    paintbench.h \
+    pixelcanvas.h \
+    pixelstore.h \
+    rasterizer.h
 
 FORMS += \
     mainwindow.ui
@@ -1,10 +1,41 @@
 #include "mainwindow.h"
+#include "paintbench.h"
 
 #include <QApplication>
+#include <QTextStream>
+
+// Воспроизведение записанного ввода без окна (per-frame время в stdout):
+//   QT_QPA_PLATFORM=offscreen ./Pixel --replay session.pxrec [--frames]
+static int runReplay(const QString &path, bool printFrames)
+{
+    QTextStream out(stdout);
+    PixelCanvas canvas;
+    if (!canvas.loadRecording(path)) {
+        QTextStream(stderr) << "Не удалось прочитать запись: " << path << "\n";
+        return 1;
+    }
+
+    const QVector<qreal> frames = canvas.replayRecording();
+    if (printFrames)
+        for (int i = 0; i < frames.size(); ++i)
+            out << i << "\t" << QString::number(frames[i], 'f', 3) << "\n";
+    out << PixelCanvas::frameTimesSummary(frames) << "\n";
+    return 0;
+}
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    const QStringList args = a.arguments();
+    const int replayIdx = args.indexOf("--replay");
+    if (replayIdx >= 0 && replayIdx + 1 < args.size())
+        return runReplay(args[replayIdx + 1], args.contains("--frames"));
+    if (args.contains("--bench-paint"))
+        return runPaintBenchmark(args);
+    if (args.contains("--bench-stroke"))
+        return runStrokeBenchmark(args);
+
     MainWindow w;
     w.show();
     return a.exec();
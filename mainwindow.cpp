@@ -10,6 +10,7 @@
 #include <QObject>
 #include <QHBoxLayout>
 #include <QShortcut>
+#include <QFileDialog>
 
 
 MainWindow::MainWindow(QWidget *parent)
@@ -62,12 +63,31 @@ void MainWindow::createMenu() {
     algMenu->addAction(createColoredAction("Брезенхем (отрезок)", QColor("#C8A5D4"), this, SLOT(setBresenhamAlg())));
     algMenu->addAction(createColoredAction("Брезенхем (окружность)", QColor("#F4A261"), this, SLOT(setCircleAlg())));
 
+    algMenu->addSeparator();
+    QAction *strokeAct = new QAction("Непрерывная линия", this);
+    strokeAct->setCheckable(true);
+    connect(strokeAct, &QAction::toggled, this, &MainWindow::toggleStrokeMode);
+    algMenu->addAction(strokeAct);
+
 
     // === Меню "Анализ" ===
     QMenu *analysisMenu = menuBar()->addMenu("Анализ");
     QAction *compareAction = new QAction("Сравнение времени работы", this);
     connect(compareAction, &QAction::triggered, this, &MainWindow::showTimingComparison);
     analysisMenu->addAction(compareAction);
+
+    analysisMenu->addSeparator();
+    QAction *recStartAct = new QAction("Начать запись ввода", this);
+    connect(recStartAct, &QAction::triggered, this, &MainWindow::startRecording);
+    analysisMenu->addAction(recStartAct);
+
+    QAction *recStopAct = new QAction("Остановить запись и сохранить...", this);
+    connect(recStopAct, &QAction::triggered, this, &MainWindow::stopRecording);
+    analysisMenu->addAction(recStopAct);
+
+    QAction *replayAct = new QAction("Воспроизвести запись...", this);
+    connect(replayAct, &QAction::triggered, this, &MainWindow::replayRecording);
+    analysisMenu->addAction(replayAct);
 }
 
 
@@ -92,12 +112,62 @@ void MainWindow::setCircleAlg() {
     statusBar()->showMessage("Выбран: Алгоритм Брезенхема (окружность)");
 }
 
+void MainWindow::toggleStrokeMode(bool on) {
+    canvas->setStrokeMode(on);
+    statusBar()->showMessage(on ? "Режим: непрерывная линия (зажмите ЛКМ и ведите)"
+                                : "Режим: отрезок по двум точкам");
+}
+
 void MainWindow::showTimingComparison() {
     QString text = canvas->getAverageTimes();
     QMessageBox::information(this, "Сравнение времени алгоритмов", text);
 }
 
 
+void MainWindow::startRecording() {
+    // запись начинается с чистого холста — иначе воспроизведение (тоже с
+    // чистого холста) разошлось бы с тем, что видел пользователь
+    if (!canvas->isBlank()
+        && QMessageBox::question(this, "Запись ввода",
+                                 "Запись начинается с чистого холста: рисунок и история отмены будут удалены. Продолжить?")
+               != QMessageBox::Yes)
+        return;
+    canvas->startRecording();
+    statusBar()->showMessage("Запись ввода начата");
+}
+
+void MainWindow::stopRecording() {
+    if (!canvas->isRecording()) {
+        statusBar()->showMessage("Запись не ведётся");
+        return;
+    }
+    canvas->stopRecording();
+
+    QString path = QFileDialog::getSaveFileName(this, "Сохранить запись", "session.pxrec",
+                                                "Запись ввода (*.pxrec)");
+    if (path.isEmpty()) return;
+    if (!canvas->saveRecording(path))
+        QMessageBox::warning(this, "Запись ввода", "Не удалось сохранить файл:\n" + path);
+    else
+        statusBar()->showMessage("Запись сохранена: " + path);
+}
+
+void MainWindow::replayRecording() {
+    QString path = QFileDialog::getOpenFileName(this, "Открыть запись", QString(),
+                                                "Запись ввода (*.pxrec)");
+    if (path.isEmpty()) return;
+    // отдельный невидимый холст: рисунок, undo/redo и вид пользователя не трогаем
+    PixelCanvas replayCanvas;
+    if (!replayCanvas.loadRecording(path)) {
+        QMessageBox::warning(this, "Запись ввода", "Не удалось прочитать файл:\n" + path);
+        return;
+    }
+
+    QString text = PixelCanvas::frameTimesSummary(replayCanvas.replayRecording());
+    QMessageBox::information(this, "Время кадров при воспроизведении", text);
+}
+
+
 QWidgetAction* MainWindow::createColoredAction(const QString& text, const QColor& color, QObject* receiver, const char* slot)
 {
     auto *button = new QPushButton(text, this);
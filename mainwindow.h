@@ -14,7 +14,11 @@ private slots:
     void setDDAAlg();
     void setBresenhamAlg();
     void setCircleAlg();
+    void toggleStrokeMode(bool on);
     void showTimingComparison();
+    void startRecording();
+    void stopRecording();
+    void replayRecording();
     void triggerUndo();
     void triggerRedo();
 
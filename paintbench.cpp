@@ -0,0 +1,162 @@
+#include "paintbench.h"
+#include "pixelcanvas.h"
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <algorithm>
+#include <QtMath>
+
+// значение опции вида "--name value" или пустая строка
+static QString optionValue(const QStringList &args, const QString &name) {
+    int i = args.indexOf(name);
+    return (i >= 0 && i + 1 < args.size()) ? args[i + 1] : QString();
+}
+
+// Ставит count различных клеток: выборка без повторений (алгоритм S Кнута)
+// из области, видимой при нулевом смещении, чтобы пиксели попадали в кадр.
+// Если клеток в ней меньше count, область расширяется. Seed фиксирован —
+// прогоны сравнимы между собой. Возвращает число реально поставленных пикселей.
+static int scatterPixels(PixelCanvas &canvas, QSize size, int cell, int count) {
+    int hw = size.width()  / (2 * cell) + 1;
+    int hh = size.height() / (2 * cell) + 1;
+    while (qint64(2 * hw + 1) * (2 * hh + 1) < count) { hw *= 2; hh *= 2; }
+
+    const int w = 2 * hw + 1;
+    const qint64 area = qint64(w) * (2 * hh + 1);
+
+    QRandomGenerator rng(12345);
+    int placed = 0;
+    for (qint64 i = 0; i < area && placed < count; ++i) {
+        // клетка i берётся с вероятностью (осталось выбрать) / (осталось клеток)
+        if (rng.generateDouble() * (area - i) >= count - placed) continue;
+        canvas.setPixel(QPoint(int(i % w) - hw, int(i / w) - hh),
+                        QColor::fromRgb(rng.generate() | 0xff000000u));
+        ++placed;
+    }
+    return placed;
+}
+
+int runPaintBenchmark(const QStringList &args) {
+    QTextStream out(stdout);
+
+    int frames = optionValue(args, "--frames").toInt();
+    if (frames <= 0) frames = 20;
+
+    QVector<QSize> sizes { {800, 600}, {1920, 1080}, {3840, 2160}, {7680, 4320} };
+    QVector<int>   cells { 4, 8, 16, 32, 64 };
+    QVector<int>   counts { 0, 1000, 100000 };
+    const QVector<QPointF> pans { {0, 0}, {25000, -25000} };
+
+    const QStringList wh = optionValue(args, "--size").split('x');
+    if (wh.size() == 2 && wh[0].toInt() > 0 && wh[1].toInt() > 0)
+        sizes = { QSize(wh[0].toInt(), wh[1].toInt()) };
+    if (optionValue(args, "--cell").toInt() > 0)
+        cells = { optionValue(args, "--cell").toInt() };
+    if (!optionValue(args, "--pixels").isEmpty())
+        counts = { std::max(0, optionValue(args, "--pixels").toInt()) };
+
+    out << "size\tcell\tpan\tpixels\tms/frame\tgrid\tlabels\toverlays\tfill\n";
+
+    for (const QSize &size : sizes) {
+        QImage frame(size, QImage::Format_ARGB32_Premultiplied);
+
+        for (int count : counts) {
+            for (int cell : cells) {
+                PixelCanvas canvas;
+                canvas.resize(size);
+                canvas.setZoom(cell);
+                const int stored = scatterPixels(canvas, size, cell, count);
+
+                for (const QPointF &pan : pans) {
+                    canvas.setPan(pan);
+                    // обе подсветки в кадре: первая точка ждёт вторую, курсор
+                    // над фиксированной клеткой (не зависит от реальной мыши)
+                    canvas.setPendingPointAt(QPoint(size.width() / 3, size.height() / 3));
+                    canvas.setCursorOverride(QPoint(size.width() * 2 / 3, size.height() * 2 / 3));
+                    canvas.render(&frame);      // прогрев (шрифты, кэши)
+
+                    PaintTimes sum;
+                    for (int f = 0; f < frames; ++f) {
+                        canvas.render(&frame);
+                        const PaintTimes t = canvas.lastPaintTimes();
+                        sum.grid += t.grid;
+                        sum.labels += t.labels;
+                        sum.overlays += t.overlays;
+                        sum.pixels += t.pixels;
+                    }
+
+                    auto ms = [&](qreal v) { return QString::number(v / frames, 'f', 3); };
+                    out << size.width() << "x" << size.height() << "\t" << cell << "\t"
+                        << pan.x() << "," << pan.y() << "\t" << stored << "\t"
+                        << ms(sum.total()) << "\t" << ms(sum.grid) << "\t" << ms(sum.labels) << "\t"
+                        << ms(sum.overlays) << "\t" << ms(sum.pixels) << "\n";
+                    out.flush();
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int runStrokeBenchmark(const QStringList &args) {
+    QTextStream out(stdout);
+
+    const QString algName = optionValue(args, "--alg");
+    AlgorithmType alg = AlgorithmType::Bresenham;
+    if (algName == "step")     alg = AlgorithmType::Step;
+    else if (algName == "dda") alg = AlgorithmType::DDA;
+
+    // быстрое ведение мыши по фигуре Лиссажу: до ~3 экранных пикселей за 1 мс
+    InputLog log;
+    log.size = QSize(1920, 1080);
+    log.cellSize = 12.0;
+    log.alg = alg;
+    log.strokeMode = true;
+
+    const int moves = 2000;
+    auto at = [&](int i) {
+        const qreal t = 2 * M_PI * i / moves;
+        return QPoint(int(960 + 700 * std::sin(t)), int(540 + 400 * std::sin(2 * t)));
+    };
+    auto event = [](quint32 ms, InputRecord::Kind kind, int buttons, QPoint pos) {
+        InputRecord r;
+        r.timeMs = ms;
+        r.kind = kind;
+        r.value = qint16(buttons);
+        r.x = pos.x();
+        r.y = pos.y();
+        return r;
+    };
+    log.events.append(event(0, InputRecord::Press, Qt::LeftButton, at(0)));
+    for (int i = 1; i <= moves; ++i)
+        log.events.append(event(quint32(i), InputRecord::Move, Qt::LeftButton, at(i)));
+    log.events.append(event(quint32(moves + 1), InputRecord::Release, Qt::LeftButton, at(moves)));
+
+    PixelCanvas canvas;
+    canvas.setRecording(log);
+
+    const QString savePath = optionValue(args, "--save");
+    if (!savePath.isEmpty() && !canvas.saveRecording(savePath)) {
+        QTextStream(stderr) << "Не удалось сохранить запись: " << savePath << "\n";
+        return 1;
+    }
+
+    // ввод (strokeTo) и кадр с перерисовкой только сегмента — как на экране;
+    // для сравнения — кадр с перерисовкой всего окна на каждое событие
+    QVector<qreal> input;
+    const QVector<qreal> dirtyFrames = canvas.replayRecording(true, &input);
+    const QVector<qreal> fullFrames = canvas.replayRecording();
+
+    auto report = [&](const QString &title, const QVector<qreal> &ms) {
+        const int overBudget = int(std::count_if(ms.begin(), ms.end(), [](qreal t) { return t > 1.0; }));
+        out << title << ":\n" << PixelCanvas::frameTimesSummary(ms) << "\n"
+            << "Дольше 1 мс (бюджет 1 кГц): " << overBudget << "\n\n";
+    };
+
+    out << "Штрих 1 кГц, " << log.size.width() << "x" << log.size.height()
+        << ", событий: " << log.events.size() << "\n\n";
+    report("Ввод (strokeTo, без отрисовки)", input);
+    report("Ввод + перерисовка сегмента", dirtyFrames);
+    report("Ввод + перерисовка всего окна", fullFrames);
+    return 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <QStringList>
+
+// Замер стоимости PixelCanvas::paintEvent без окна: холст рендерится в QImage
+// через QWidget::render(), перебираются размер виджета, зум, смещение и число
+// пикселей. Запуск:
+//   QT_QPA_PLATFORM=offscreen ./Pixel --bench-paint [--frames N]
+//       [--size WxH] [--cell N] [--pixels N]
+int runPaintBenchmark(const QStringList &args);
+
+// Штрих с частотой ввода 1 кГц: синтезируется журнал (нажатие, 2000 событий
+// перемещения через 1 мс, отпускание) и проигрывается, как --replay.
+// Выводит время кадров и долю событий дольше бюджета 1 мс. --save сохраняет
+// журнал в .pxrec для повторного --replay.
+//   QT_QPA_PLATFORM=offscreen ./Pixel --bench-stroke [--alg step|dda|bresenham]
+//       [--save stroke.pxrec]
+int runStrokeBenchmark(const QStringList &args);
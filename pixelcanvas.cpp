@@ -1,11 +1,16 @@
 #include "pixelcanvas.h"
+#include "rasterizer.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QResizeEvent>
 #include <cmath>
 #include <algorithm>
 #include <QElapsedTimer>
 #include <QDebug>
+#include <QFile>
+#include <QDataStream>
+#include <QImage>
 
 
 PixelCanvas::PixelCanvas(QWidget *parent) : QWidget(parent) {
@@ -13,9 +18,18 @@ PixelCanvas::PixelCanvas(QWidget *parent) : QWidget(parent) {
     setMinimumSize(800, 600);
 }
 
-void PixelCanvas::clear() { pixels.clear(); update(); }
+void PixelCanvas::clear() { recordInput(InputRecord::Clear, 0); pixels.clear(); update(); }
+
+void PixelCanvas::setStrokeMode(bool on) {
+    recordInput(InputRecord::StrokeMode, on);
+    strokeMode = on;
+    stroking = false;
+    waitingSecond = false;   // незавершённый двухточечный примитив сбрасываем
+    update();
+}
 
 void PixelCanvas::setZoom(int v) {
+    recordInput(InputRecord::Zoom, v);
     cellSize = std::clamp<qreal>(v, 4.0, 64.0);
     update();
 }
@@ -39,9 +53,13 @@ QPoint PixelCanvas::screenToGrid(QPoint s) const {
 }
 
 void PixelCanvas::setPixel(QPoint g, const QColor& c) {
-    pixels[g] = c;
+    pixels.set(g, c.rgba());
 }
 
+// в журнал ввода пишутся только основные кнопки: флаги Qt::ExtraButton*
+// (0x8 и выше, до 0x4000000) не помещаются в qint16 поля InputRecord::value
+static const int RecordedButtons = Qt::LeftButton | Qt::RightButton | Qt::MiddleButton;
+
 static QColor algorithmColor(AlgorithmType type) {
     switch (type) {
     case AlgorithmType::Step:      return QColor(0, 120, 255);   // синий
@@ -67,9 +85,23 @@ static int computeTickStep(qreal cellSize) {
     return int(nice * pow10);
 }
 
-void PixelCanvas::paintEvent(QPaintEvent*) {
+// подписи делений рисуются правее/выше своей клетки: деления в этих пределах
+// за перерисовываемой областью могут заходить в неё текстом
+static const int LabelMargin = 64;
+
+void PixelCanvas::paintEvent(QPaintEvent *e) {
+    // перерисовывается только e->rect(): сетка, подписи и пиксели перебираются
+    // в его пределах (при штрихе это прямоугольник одного сегмента)
+    const QRect dirty = e->rect();
+
+    // замер по этапам: сетка+оси, подписи, подсветки, пиксели
+    QElapsedTimer phase;
+    phase.start();
+    qint64 mark = 0;
+    auto lap = [&]() { qint64 now = phase.nsecsElapsed(); qreal ms = (now - mark) / 1e6; mark = now; return ms; };
+
     QPainter p(this);
-    p.fillRect(rect(), Qt::white);
+    p.fillRect(dirty, Qt::white);
 
     // --- адаптивная сетка ---
     p.save();
@@ -84,8 +116,8 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
     QColor fineColor(230,230,230);
     QColor boldColor(200,200,200);
 
-    QPointF gLT = screenToGridF(QPointF(0,0));
-    QPointF gRB = screenToGridF(QPointF(width(),height()));
+    QPointF gLT = screenToGridF(QPointF(dirty.left(), dirty.top()));
+    QPointF gRB = screenToGridF(QPointF(dirty.right() + 1, dirty.bottom() + 1));
     int gxMin = std::floor(std::min(gLT.x(), gRB.x()));
     int gxMax = std::ceil (std::max(gLT.x(), gRB.x()));
     int gyMin = std::floor(std::min(gLT.y(), gRB.y()));
@@ -125,9 +157,10 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
     const qreal ox = originPx().x() + panPx.x();
     const qreal oy = originPx().y() + panPx.y();
 
-    p.drawLine(QPointF(0, oy), QPointF(width(), oy));   // X
-    p.drawLine(QPointF(ox, 0), QPointF(ox, height()));  // Y
+    p.drawLine(QPointF(dirty.left(), oy), QPointF(dirty.right() + 1, oy));   // X
+    p.drawLine(QPointF(ox, dirty.top()), QPointF(ox, dirty.bottom() + 1));  // Y
     p.restore();
+    paintTimes.grid = lap();
 
     // --- подписи делений ---
     p.save();
@@ -138,7 +171,14 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
 
     const int tickStep = computeTickStep(cellSize);
 
-    for (int gx = gxMin; gx <= gxMax; ++gx) {
+    // подписи стоят вдоль осей: если ось далеко от области, её подписи не нужны
+    const QRect labelArea = dirty.adjusted(-LabelMargin, -LabelMargin, LabelMargin, LabelMargin);
+    const QPointF lLT = screenToGridF(QPointF(labelArea.left(), labelArea.top()));
+    const QPointF lRB = screenToGridF(QPointF(labelArea.right() + 1, labelArea.bottom() + 1));
+    const bool xLabels = oy >= labelArea.top() && oy <= labelArea.bottom();
+    const bool yLabels = ox >= labelArea.left() && ox <= labelArea.right();
+
+    for (int gx = int(std::floor(lLT.x())); xLabels && gx <= int(std::ceil(lRB.x())); ++gx) {
         if (gx % tickStep == 0) {
             QPoint sp = gridToScreen(QPoint(gx, 0));
             if (gx != 0)
@@ -146,7 +186,7 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
         }
     }
 
-    for (int gy = gyMin; gy <= gyMax; ++gy) {
+    for (int gy = int(std::floor(lRB.y())); yLabels && gy <= int(std::ceil(lLT.y())); ++gy) {
         if (gy % tickStep == 0) {
             QPoint sp = gridToScreen(QPoint(0, gy));
             if (gy != 0)
@@ -156,6 +196,7 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
         }
     }
     p.restore();
+    paintTimes.labels = lap();
 
     // --- Подсветка первой точки при ожидании второй ---
     if (waitingSecond) {
@@ -168,7 +209,7 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
 
 
     // --- подсветка клетки под курсором ---
-    QPoint cursor = mapFromGlobal(QCursor::pos());
+    QPoint cursor = cursorOverridden ? cursorPos : mapFromGlobal(QCursor::pos());
     if (rect().contains(cursor)) {
         QPoint g = screenToGrid(cursor);
         QPoint s = gridToScreen(g);
@@ -178,20 +219,23 @@ void PixelCanvas::paintEvent(QPaintEvent*) {
         p.drawRect(r);
     }
 
+    paintTimes.overlays = lap();
+
     // --- отрисовка пикселей ---
     p.setPen(Qt::NoPen);
-    for (auto it = pixels.constBegin(); it != pixels.constEnd(); ++it) {
-        const QPoint& g = it.key();
-        if (g.x() < gxMin-1 || g.x() > gxMax+1 || g.y() < gyMin-1 || g.y() > gyMax+1) continue;
+    const QRect visible(QPoint(gxMin-1, gyMin-1), QPoint(gxMax+1, gyMax+1));
+    pixels.forEachIn(visible, [&](QPoint g, QRgb c) {
         QPoint s = gridToScreen(g);
         QRect r(s.x(), s.y(), int(std::ceil(cellSize)), int(std::ceil(cellSize)));
-        p.fillRect(r, it.value());
-    }
+        p.fillRect(r, QColor::fromRgba(c));
+    });
+    paintTimes.pixels = lap();
 }
 
 
 // ---------- мышь / зум ----------
 void PixelCanvas::mousePressEvent(QMouseEvent *e) {
+    recordInput(InputRecord::Press, int(e->button()) & RecordedButtons, e->pos());
     if (e->button() == Qt::RightButton) { panning = true; lastMouse = e->pos(); return; }
 
     if (e->button() == Qt::LeftButton) {
@@ -201,6 +245,17 @@ void PixelCanvas::mousePressEvent(QMouseEvent *e) {
 
         QPoint g = screenToGrid(e->pos());
 
+        // непрерывная линия: одна запись undo на весь штрих, первая вершина
+        // пишется сразу, остальные сегменты — в mouseMoveEvent
+        if (strokeMode && currentAlg != AlgorithmType::Circle) {
+            saveState();
+            stroking = true;
+            strokeLast = g;
+            setPixel(g, algorithmColor(currentAlg));
+            update();
+            return;
+        }
+
         // первая точка — просто сохраняем и подсвечиваем
         if (!waitingSecond) {
             firstPt = g;
@@ -217,12 +272,9 @@ void PixelCanvas::mousePressEvent(QMouseEvent *e) {
             case AlgorithmType::Step:      drawLineStep(firstPt, b); break;
             case AlgorithmType::DDA:       drawLineDDA(firstPt, b); break;
             case AlgorithmType::Bresenham: drawLineBresenham(firstPt, b); break;
-            case AlgorithmType::Circle: {
-                int dx = b.x() - firstPt.x();
-                int dy = b.y() - firstPt.y();
-                drawCircleBresenham(firstPt, int(std::lround(std::sqrt(dx*dx + dy*dy))));
+            case AlgorithmType::Circle:
+                drawCircleBresenham(firstPt, Raster::radiusFromPoints(firstPt, b));
                 break;
-            }
             default: break;
             }
 
@@ -233,21 +285,69 @@ void PixelCanvas::mousePressEvent(QMouseEvent *e) {
 }
 
 void PixelCanvas::mouseMoveEvent(QMouseEvent *e) {
+    recordInput(InputRecord::Move, int(e->buttons()) & RecordedButtons, e->pos());
     if (panning) {
         panPx += (e->pos() - lastMouse);
         lastMouse = e->pos();
         update();
+    } else if (stroking) {
+        QPoint g = screenToGrid(e->pos());
+        emit cursorPositionChanged(g);
+        strokeTo(g);
     } else {
         emit cursorPositionChanged(screenToGrid(e->pos()));
         update(); // чтобы подсветка следовала
     }
 }
 void PixelCanvas::mouseReleaseEvent(QMouseEvent *e) {
+    recordInput(InputRecord::Release, int(e->button()) & RecordedButtons, e->pos());
     if (e->button() == Qt::RightButton) panning = false;
+
+    if (e->button() == Qt::LeftButton && stroking) {
+        strokeTo(screenToGrid(e->pos()));   // сам перерисует свой сегмент
+        stroking = false;
+    }
 }
+
+// Добавляет к штриху сегмент strokeLast -> g. Общая вершина уже нарисована
+// предыдущим сегментом, поэтому начальная точка пропускается. Если алгоритм
+// не попал в g, клетка дописывается явно — иначе следующий сегмент оставил бы
+// разрыв. Сегменты штриха не идут в статистику времени (drawLine*): их сотни
+// на штрих по 1–2 клетки, они исказили бы средние для отрезков. Перерисовывается
+// только прямоугольник сегмента (в него попадают и обе клетки курсора).
+void PixelCanvas::strokeTo(QPoint g) {
+    strokeDirty = QRect();
+    if (g == strokeLast) return;
+
+    const QColor color = algorithmColor(currentAlg);
+    bool endPlotted = false;
+    auto plot = [&](QPoint p) { setPixel(p, color); endPlotted |= (p == g); };
+
+    switch (currentAlg) {
+    case AlgorithmType::Step:      Raster::lineStep(strokeLast, g, true, plot); break;
+    case AlgorithmType::DDA:       Raster::lineDDA(strokeLast, g, true, plot); break;
+    case AlgorithmType::Bresenham: Raster::lineBresenham(strokeLast, g, true, plot); break;
+    default: break;
+    }
+    if (!endPlotted) setPixel(g, color);
+
+    const int cell = int(std::ceil(cellSize));
+    strokeDirty = QRect(gridToScreen(strokeLast), gridToScreen(g)).normalized()
+                      .adjusted(-1, -1, cell + 1, cell + 1);
+    strokeLast = g;
+    update(strokeDirty);
+}
+void PixelCanvas::resizeEvent(QResizeEvent *e) {
+    // начало координат — центр виджета, поэтому размер окна влияет на то,
+    // в какие клетки попадают записанные позиции мыши
+    recordInput(InputRecord::Resize, 0, QPoint(e->size().width(), e->size().height()));
+    QWidget::resizeEvent(e);
+}
+
 void PixelCanvas::wheelEvent(QWheelEvent *e) {
     // зум к курсору: сохраняем логическую координату под курсором
     QPointF s = e->position();
+    recordInput(InputRecord::Wheel, std::clamp(e->angleDelta().y(), -32768, 32767), s.toPoint());
     QPointF gBefore = screenToGridF(s);
 
     cellSize = std::clamp(cellSize * (e->angleDelta().y() > 0 ? 1.1 : 0.9), 4.0, 64.0);
@@ -285,6 +385,7 @@ void PixelCanvas::saveState() {
 }
 
 void PixelCanvas::undo() {
+    recordInput(InputRecord::Undo, 0);
     if (!undoStack.isEmpty()) {
         redoStack.push(pixels);   // текущее состояние — в redo
         pixels = undoStack.pop(); // откат к предыдущему
@@ -293,6 +394,7 @@ void PixelCanvas::undo() {
 }
 
 void PixelCanvas::redo() {
+    recordInput(InputRecord::Redo, 0);
     if (!redoStack.isEmpty()) {
         undoStack.push(pixels);   // текущее состояние — в undo
         pixels = redoStack.pop(); // восстановление
@@ -305,133 +407,269 @@ void PixelCanvas::redo() {
 
 
 
-// ---------- алгоритмы с измерением времени ----------
-void PixelCanvas::drawLineStep(QPoint a, QPoint b) {
-    QElapsedTimer timer;
-    timer.start();
+// ---------- запись / воспроизведение ввода ----------
+// Формат файла: заголовок (магия, версия, размер виджета, зум, смещение,
+// алгоритм, режим штриха) и затем события по InputRecord::StreamSize байт.
+// Версия 2 добавила события Resize; файлы версии 1 читаются как есть.
 
-    QColor color = algorithmColor(currentAlg);
+static const quint32 InputLogMagic   = 0x50585231;   // "PXR1"
+static const quint16 InputLogVersion = 2;
 
-    int x1 = a.x(), y1 = a.y();
-    int x2 = b.x(), y2 = b.y();
+// пределы для значений из файла: за ними холст не работает осмысленно
+// (QImage такого размера не создать, координаты клеток не помещаются в int)
+static const int   MaxRecordedSide = 16384;
+static const qreal MaxRecordedPan  = 1e9;
 
-    int dx = x2 - x1;
-    int dy = y2 - y1;
+static bool validRecordedSize(int w, int h) {
+    return w > 0 && h > 0 && w <= MaxRecordedSide && h <= MaxRecordedSide;
+}
 
-    // вертикальная линия
-    if (dx == 0) {
-        int y_min = std::min(y1, y2);
-        int y_max = std::max(y1, y2);
-        for (int y = y_min; y <= y_max; ++y)
-            setPixel(QPoint(x1, y), color);
-        timesStep.append(timer.nsecsElapsed() / 1e6);
-        return;
-    }
+static bool validRecordedPan(QPointF pan) {
+    return std::isfinite(pan.x()) && std::isfinite(pan.y())
+        && std::abs(pan.x()) <= MaxRecordedPan && std::abs(pan.y()) <= MaxRecordedPan;
+}
 
-    float k = static_cast<float>(dy) / static_cast<float>(dx);
+static bool validAlgorithm(int a) {
+    return a >= int(AlgorithmType::None) && a <= int(AlgorithmType::Circle);
+}
 
-    // пологая линия (шагаем по X)
-    if (std::abs(dx) >= std::abs(dy)) {
-        if (x1 > x2) { std::swap(x1, x2); std::swap(y1, y2); dx = x2 - x1; dy = y2 - y1; k = static_cast<float>(dy) / dx; }
+void PixelCanvas::startRecording() {
+    // воспроизведение начинается с пустого холста без истории и без
+    // незавершённых примитивов — запись начинается с того же состояния
+    pixels.clear();
+    undoStack.clear();
+    redoStack.clear();
+    stroking = waitingSecond = panning = false;
+    update();
 
-        for (int x = x1; x <= x2; ++x) {
-            int y = static_cast<int>(std::round(y1 + k * (x - x1)));
-            setPixel(QPoint(x, y), color);
-        }
-    }
-    // крутая линия (шагаем по Y)
-    else {
-        if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); dx = x2 - x1; dy = y2 - y1; k = static_cast<float>(dy) / dx; }
-
-        float inv_k = static_cast<float>(dx) / static_cast<float>(dy);
-        for (int y = y1; y <= y2; ++y) {
-            int x = static_cast<int>(std::round(x1 + inv_k * (y - y1)));
-            setPixel(QPoint(x, y), color);
-        }
-    }
+    inputLog = InputLog();
+    inputLog.size = size();
+    inputLog.cellSize = cellSize;
+    inputLog.pan = panPx;
+    inputLog.alg = currentAlg;
+    inputLog.strokeMode = strokeMode;
+    recordClock.start();
+    recording = true;
+}
 
-    qreal t = timer.nsecsElapsed() / 1e6;
-    timesStep.append(t);
-    qDebug() << "Step algorithm time:" << t << "ms";
+void PixelCanvas::recordInput(InputRecord::Kind kind, int value, QPoint pos) {
+    if (!recording) return;
+    InputRecord r;
+    r.timeMs = quint32(recordClock.elapsed());
+    r.kind = kind;
+    r.value = qint16(value);
+    r.x = pos.x();
+    r.y = pos.y();
+    inputLog.events.append(r);
 }
 
+bool PixelCanvas::saveRecording(const QString &path) const {
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << InputLogMagic << InputLogVersion
+        << inputLog.size << inputLog.cellSize << inputLog.pan
+        << qint32(inputLog.alg) << inputLog.strokeMode
+        << quint32(inputLog.events.size());
+    for (const InputRecord &r : inputLog.events)
+        out << r.timeMs << r.kind << r.value << r.x << r.y;
+    return out.status() == QDataStream::Ok;
+}
 
-void PixelCanvas::drawLineDDA(QPoint a, QPoint b) {
-    QElapsedTimer timer;
-    timer.start();
+bool PixelCanvas::loadRecording(const QString &path) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != InputLogMagic || version < 1 || version > InputLogVersion) return false;
+
+    InputLog log;
+    qint32 alg = 0;
+    quint32 count = 0;
+    in >> log.size >> log.cellSize >> log.pan >> alg >> log.strokeMode >> count;
+    if (in.status() != QDataStream::Ok) return false;
+
+    // заголовку из файла не доверяем: зум приводим к допустимому, остальное
+    // вне пределов — повреждённый файл
+    if (!validRecordedSize(log.size.width(), log.size.height()) || !std::isfinite(log.cellSize)
+        || !validRecordedPan(log.pan) || !validAlgorithm(alg))
+        return false;
+    log.cellSize = std::clamp<qreal>(log.cellSize, 4.0, 64.0);
+    log.alg = AlgorithmType(alg);
+
+    const quint8 lastKind = version < 2 ? InputRecord::Clear : InputRecord::Resize;
+    // не доверяем счётчику из файла: резервируем не больше, чем реально влезает
+    log.events.reserve(int(std::min<qint64>(count, f.size() / InputRecord::StreamSize)));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InputRecord r;
+        in >> r.timeMs >> r.kind >> r.value >> r.x >> r.y;
+        if (r.kind > lastKind
+            || (r.kind == InputRecord::Algorithm && !validAlgorithm(r.value))
+            || (r.kind == InputRecord::Resize && !validRecordedSize(r.x, r.y)))
+            return false;
+        log.events.append(r);
+    }
+    if (in.status() != QDataStream::Ok) return false;
 
-    int x1 = a.x();
-    int y1 = a.y();
-    int x2 = b.x();
-    int y2 = b.y();
+    recording = false;
+    inputLog = log;
+    return true;
+}
 
-    int dx = x2 - x1;
-    int dy = y2 - y1;
+void PixelCanvas::applyInput(const InputRecord &r) {
+    const QPointF pos(r.x, r.y);
+    switch (r.kind) {
+    case InputRecord::Press: {
+        QMouseEvent ev(QEvent::MouseButtonPress, pos, Qt::MouseButton(r.value),
+                       Qt::MouseButtons(r.value), Qt::NoModifier);
+        mousePressEvent(&ev);
+        break;
+    }
+    case InputRecord::Move: {
+        QMouseEvent ev(QEvent::MouseMove, pos, Qt::NoButton,
+                       Qt::MouseButtons(r.value), Qt::NoModifier);
+        mouseMoveEvent(&ev);
+        break;
+    }
+    case InputRecord::Release: {
+        QMouseEvent ev(QEvent::MouseButtonRelease, pos, Qt::MouseButton(r.value),
+                       Qt::NoButton, Qt::NoModifier);
+        mouseReleaseEvent(&ev);
+        break;
+    }
+    case InputRecord::Wheel: {
+        QWheelEvent ev(pos, pos, QPoint(), QPoint(0, r.value),
+                       Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+        wheelEvent(&ev);
+        break;
+    }
+    case InputRecord::Algorithm:  setAlgorithm(AlgorithmType(r.value)); break;
+    case InputRecord::StrokeMode: setStrokeMode(r.value != 0); break;
+    case InputRecord::Zoom:       setZoom(r.value); break;
+    case InputRecord::Undo:       undo(); break;
+    case InputRecord::Redo:       redo(); break;
+    case InputRecord::Clear:      clear(); break;
+    case InputRecord::Resize:     resize(r.x, r.y); break;
+    default: break;
+    }
+}
 
-    int L = std::max(std::abs(dx), std::abs(dy));
-    if (L == 0) {
-        setPixel(a);
-        qDebug() << "DDA algorithm time:" << timer.nsecsElapsed() / 1e6 << "ms";
-        return;
+// Проигрывает журнал без пауз: каждое событие применяется и кадр сразу
+// отрисовывается. dirtyOnly — как на экране: сегмент штриха перерисовывает
+// только свой прямоугольник (или ничего, если клетка не сменилась), остальные
+// события — весь кадр; иначе каждый кадр рисуется целиком. В inputMs, если
+// задан, — время обработки одного события без отрисовки. Холст, undo/redo, зум, смещение и размер сбрасываются к
+// состоянию записи, поэтому вызывать на отдельном экземпляре PixelCanvas.
+// Кадр рисуется в QImage через render(), поэтому работает и без показа окна
+// (QT_QPA_PLATFORM=offscreen). Подсветка под курсором берётся из позиции
+// последнего записанного события мыши, а не из реального курсора — кадры
+// воспроизводятся одинаково. Время кадра = обработка события + paintEvent.
+QVector<qreal> PixelCanvas::replayRecording(bool dirtyOnly, QVector<qreal> *inputMs) {
+    recording = false;
+    if (inputLog.size.isValid()) resize(inputLog.size);
+
+    pixels.clear();
+    undoStack.clear();
+    redoStack.clear();
+    cellSize = inputLog.cellSize;
+    panPx = inputLog.pan;
+    currentAlg = inputLog.alg;
+    strokeMode = inputLog.strokeMode;
+    stroking = waitingSecond = panning = false;
+    setCursorOverride(QPoint(-1, -1));   // до первого события мыши курсора нет
+
+    QImage frame(size(), QImage::Format_ARGB32_Premultiplied);
+    QVector<qreal> frames;
+    frames.reserve(inputLog.events.size());
+    if (inputMs) {
+        inputMs->clear();
+        inputMs->reserve(inputLog.events.size());
     }
 
-    float x_inc = dx / static_cast<float>(L);
-    float y_inc = dy / static_cast<float>(L);
+    QElapsedTimer timer;
+    for (const InputRecord &r : inputLog.events) {
+        // движение и отпускание левой кнопки во время штриха обрабатывает
+        // только strokeTo, и перерисовывается только strokeDirty
+        const bool strokeSegment = stroking && !panning
+            && (r.kind == InputRecord::Move || (r.kind == InputRecord::Release && r.value == Qt::LeftButton));
+
+        timer.start();
+        if (r.kind <= InputRecord::Wheel) cursorPos = QPoint(r.x, r.y);   // Press..Wheel — события мыши
+        applyInput(r);
+        if (inputMs) inputMs->append(timer.nsecsElapsed() / 1e6);
+
+        if (frame.size() != size())   // событие Resize
+            frame = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+        const QRect region = strokeDirty.intersected(rect());
+        if (!dirtyOnly || !strokeSegment)
+            render(&frame);
+        else if (!region.isEmpty())   // пустая sourceRegion у render() — «весь виджет»
+            render(&frame, region.topLeft(), QRegion(region));
+        frames.append(timer.nsecsElapsed() / 1e6);
+    }
 
-    float x = x1;
-    float y = y1;
+    clearCursorOverride();
+    return frames;
+}
 
-    for (int i = 0; i <= L; i++) {
-        setPixel(QPoint(std::round(x), std::round(y)), algorithmColor(currentAlg));
-        x += x_inc;
-        y += y_inc;
-    }
+QString PixelCanvas::frameTimesSummary(QVector<qreal> frames) {
+    if (frames.isEmpty()) return QString("Кадров: 0");
 
-    // --- DDA ---
-    qreal t = timer.nsecsElapsed() / 1e6;
-    timesDDA.append(t);
-    qDebug() << "DDA algorithm time:" << t << "ms";
+    qreal sum = 0;
+    for (auto t : frames) sum += t;
+    std::sort(frames.begin(), frames.end());
+    auto pct = [&](qreal q) { return frames[std::min(frames.size() - 1, int(q * frames.size()))]; };
+
+    return QString("Кадров: %1\nСреднее: %2 мс\nМедиана: %3 мс\n95%: %4 мс\nМакс: %5 мс")
+        .arg(frames.size())
+        .arg(sum / frames.size(), 0, 'f', 3)
+        .arg(pct(0.5), 0, 'f', 3)
+        .arg(pct(0.95), 0, 'f', 3)
+        .arg(frames.last(), 0, 'f', 3);
 }
 
 
-void PixelCanvas::drawLineBresenham(QPoint a, QPoint b) {
+// ---------- алгоритмы с измерением времени ----------
+// Сами алгоритмы — в rasterizer.h; здесь только цвет, запись и замер времени.
+void PixelCanvas::drawLineStep(QPoint a, QPoint b) {
     QElapsedTimer timer;
     timer.start();
 
-    int x1 = a.x();
-    int y1 = a.y();
-    int x2 = b.x();
-    int y2 = b.y();
+    const QColor color = algorithmColor(currentAlg);
+    Raster::lineStep(a, b, false, [&](QPoint g) { setPixel(g, color); });
 
-    int dx = std::abs(x2 - x1);
-    int dy = std::abs(y2 - y1);
+    qreal t = timer.nsecsElapsed() / 1e6;
+    timesStep.append(t);
+    qDebug() << "Step algorithm time:" << t << "ms";
+}
 
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
 
-    bool steep = dy > dx;
-    if (steep) std::swap(dx, dy);
+void PixelCanvas::drawLineDDA(QPoint a, QPoint b) {
+    QElapsedTimer timer;
+    timer.start();
 
-    int err = 2 * dy - dx;
+    const QColor color = algorithmColor(currentAlg);
+    Raster::lineDDA(a, b, false, [&](QPoint g) { setPixel(g, color); });
 
-    for (int i = 0; i <= dx; i++) {
-        setPixel(QPoint(x1, y1), algorithmColor(currentAlg));
+    // --- DDA ---
+    qreal t = timer.nsecsElapsed() / 1e6;
+    timesDDA.append(t);
+    qDebug() << "DDA algorithm time:" << t << "ms";
+}
 
-        if (err >= 0) {
-            if (steep)
-                x1 += sx;
-            else
-                y1 += sy;
-            err -= 2 * dx;
-        }
 
-        if (steep)
-            y1 += sy;
-        else
-            x1 += sx;
+void PixelCanvas::drawLineBresenham(QPoint a, QPoint b) {
+    QElapsedTimer timer;
+    timer.start();
 
-        err += 2 * dy;
-    }
+    const QColor color = algorithmColor(currentAlg);
+    Raster::lineBresenham(a, b, false, [&](QPoint g) { setPixel(g, color); });
 
     // --- Bresenham (line) ---
     qreal t = timer.nsecsElapsed() / 1e6;
@@ -444,37 +682,8 @@ void PixelCanvas::drawCircleBresenham(QPoint center, int radius) {
     QElapsedTimer timer;
     timer.start();
 
-    int x0 = center.x();
-    int y0 = center.y();
-
-    int x = 0;
-    int y = radius;
-    int d = 3 - 2 * radius;
-
-    auto drawSymmetricPoints = [&](int x, int y) {
-        QColor c = algorithmColor(currentAlg);
-        setPixel(QPoint(x0 + x, y0 + y), c);
-        setPixel(QPoint(x0 - x, y0 + y), c);
-        setPixel(QPoint(x0 + x, y0 - y), c);
-        setPixel(QPoint(x0 - x, y0 - y), c);
-        setPixel(QPoint(x0 + y, y0 + x), c);
-        setPixel(QPoint(x0 - y, y0 + x), c);
-        setPixel(QPoint(x0 + y, y0 - x), c);
-        setPixel(QPoint(x0 - y, y0 - x), c);
-    };
-
-    while (x <= y) {
-        drawSymmetricPoints(x, y);
-
-        if (d >= 0) {
-            d += 4 * (x - y) + 10;
-            y--;
-        } else {
-            d += 4 * x + 6;
-        }
-
-        x++;
-    }
+    const QColor color = algorithmColor(currentAlg);
+    Raster::circleBresenham(center, radius, [&](QPoint g) { setPixel(g, color); });
 
     // --- Bresenham (circle) ---
     qreal t = timer.nsecsElapsed() / 1e6;
@@ -6,14 +6,44 @@
 #include <QStack>
 #include <QMap>
 #include <QDebug>
+#include <QVector>
+#include <QSize>
+#include <QElapsedTimer>
+#include "pixelstore.h"
 
 
 enum class AlgorithmType { None, Step, DDA, Bresenham, Circle };
 
+// время последнего paintEvent по этапам, мс
+struct PaintTimes {
+    qreal grid = 0;       // фон, сетка, оси
+    qreal labels = 0;     // подписи делений
+    qreal overlays = 0;   // подсветка первой точки и клетки под курсором
+    qreal pixels = 0;     // заливка нарисованных пикселей
+    qreal total() const { return grid + labels + overlays + pixels; }
+};
+
+// одно событие ввода в журнале записи (StreamSize байт в файле)
+struct InputRecord {
+    enum Kind : quint8 { Press, Move, Release, Wheel, Algorithm, StrokeMode, Zoom, Undo, Redo, Clear, Resize };
+    quint32 timeMs = 0;     // от начала записи
+    quint8  kind = Press;
+    qint16  value = 0;      // кнопки мыши (только левая/правая/средняя) / delta колеса / алгоритм / флаг / зум
+    qint32  x = 0, y = 0;   // позиция в координатах виджета / новый размер (Resize)
+
+    // размер записи в QDataStream: поля пишутся подряд без выравнивания
+    static constexpr int StreamSize = sizeof(quint32) + sizeof(quint8) + sizeof(qint16) + 2 * sizeof(qint32);
+};
 
-inline uint qHash(const QPoint &key, uint seed = 0) noexcept {
-    return qHash(QPair<int,int>(key.x(), key.y()), seed);
-}
+// журнал ввода + состояние вида на момент начала записи
+struct InputLog {
+    QSize  size;
+    qreal  cellSize = 12.0;
+    QPointF pan;
+    AlgorithmType alg = AlgorithmType::None;
+    bool   strokeMode = false;
+    QVector<InputRecord> events;
+};
 
 class PixelCanvas : public QWidget {
     Q_OBJECT
@@ -21,11 +51,37 @@ public:
     explicit PixelCanvas(QWidget *parent = nullptr);
 
     void clear();
-    void setAlgorithm(AlgorithmType a) { currentAlg = a; }
+    void setAlgorithm(AlgorithmType a) { currentAlg = a; recordInput(InputRecord::Algorithm, int(a)); }
+    void setStrokeMode(bool on);        // непрерывная линия (ломаная) вместо двух кликов
+    bool isStrokeMode() const { return strokeMode; }
     int  getZoom() const { return int(cellSize); }
     void setZoom(int v);                // дискретный шаг увеличения
+    void setPan(QPointF px) { panPx = px; update(); }
+    PaintTimes lastPaintTimes() const { return paintTimes; }
     QString getAverageTimes() const;
 
+    // пиксельная запись
+    void setPixel(QPoint g, const QColor& c = Qt::black);
+
+    // позиция курсора для подсветки клетки (координаты виджета) вместо
+    // QCursor::pos(): бенчмарк и воспроизведение не зависят от реальной мыши
+    void setCursorOverride(QPoint pos) { cursorOverridden = true; cursorPos = pos; update(); }
+    void clearCursorOverride() { cursorOverridden = false; update(); }
+    // первая точка примитива под pos (координаты виджета), как после первого клика
+    void setPendingPointAt(QPoint pos) { firstPt = screenToGrid(pos); waitingSecond = true; update(); }
+
+    // запись / воспроизведение ввода
+    bool isBlank() const { return pixels.isEmpty() && undoStack.isEmpty() && redoStack.isEmpty(); }
+    void startRecording();              // очищает холст и undo/redo: журнал начинается с чистого холста
+    void stopRecording() { recording = false; }
+    bool isRecording() const { return recording; }
+    bool saveRecording(const QString &path) const;
+    bool loadRecording(const QString &path);
+    void setRecording(const InputLog &log) { recording = false; inputLog = log; }
+    // время кадра (событие + отрисовка), мс; сбрасывает холст
+    QVector<qreal> replayRecording(bool dirtyOnly = false, QVector<qreal> *inputMs = nullptr);
+    static QString frameTimesSummary(QVector<qreal> frames);
+
 
 public slots:
     void undo();
@@ -40,6 +96,7 @@ protected:
     void mouseMoveEvent(QMouseEvent *) override;
     void mouseReleaseEvent(QMouseEvent *) override;
     void wheelEvent(QWheelEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
 
 private:
     // === состояние «бесконечного» холста ===
@@ -47,21 +104,37 @@ private:
     QPointF panPx {0,0};                // смещение холста в пикселях
     AlgorithmType currentAlg = AlgorithmType::None;
 
-    // нарисованные пиксели: ключ = целочисленные координаты сетки
-    QHash<QPoint, QColor> pixels;
+    // нарисованные пиксели (блоки copy-on-write, снимки почти бесплатны)
+    PixelStore pixels;
 
 
-    QStack<QHash<QPoint, QColor>> undoStack;
-    QStack<QHash<QPoint, QColor>> redoStack;
+    QStack<PixelStore> undoStack;
+    QStack<PixelStore> redoStack;
 
 
     void saveState();
 
+    // запись ввода
+    bool recording = false;
+    QElapsedTimer recordClock;
+    InputLog inputLog;
+    void recordInput(InputRecord::Kind kind, int value, QPoint pos = QPoint());
+    void applyInput(const InputRecord &r);
+
     // взаимодействие
     bool panning = false;
     QPoint lastMouse;
     bool waitingSecond = false;
     QPoint firstPt;
+    bool cursorOverridden = false;
+    QPoint cursorPos;
+
+    // непрерывная линия: сегменты добавляются при движении мыши
+    bool strokeMode = false;
+    bool stroking = false;              // кнопка зажата, штрих идёт
+    QPoint strokeLast;                  // последняя вершина штриха
+    QRect strokeDirty;                  // что перерисовал последний strokeTo (пусто — ничего)
+    void strokeTo(QPoint g);
 
 
     // преобразования координат
@@ -71,9 +144,6 @@ private:
     QPointF screenToGridF(QPointF s) const;     // экран -> логические (вещественные)
     QPoint   screenToGrid(QPoint s) const;      // экран -> целочисленные (по полу)
 
-    // пиксельная запись/отрисовка
-    void setPixel(QPoint g, const QColor& c = Qt::black);
-
     // алгоритмы
     void drawLineStep(QPoint a, QPoint b);
     void drawLineDDA(QPoint a, QPoint b);
@@ -86,6 +156,7 @@ private:
     QVector<qreal> timesDDA;
     QVector<qreal> timesBresenhamLine;
     QVector<qreal> timesBresenhamCircle;
+    PaintTimes paintTimes;
 
 
 };
@@ -0,0 +1,112 @@
+#pragma once
+#include <QHash>
+#include <QPoint>
+#include <QRect>
+#include <QRgb>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QtAlgorithms>
+
+
+inline uint qHash(const QPoint &key, uint seed = 0) noexcept {
+    return qHash(QPair<int,int>(key.x(), key.y()), seed);
+}
+
+// Блок 32x32 клеток: маска занятых клеток по строкам + цвета.
+struct PixelTile : QSharedData {
+    static constexpr int Shift = 5;
+    static constexpr int Size  = 1 << Shift;
+
+    quint32 rowMask[Size] = {};
+    QRgb    color[Size * Size] = {};   // обнуляем: клон копирует весь блок
+};
+
+// Хранилище нарисованных пикселей из разделяемых блоков (copy-on-write).
+// Копия хранилища (снимок для undo и т.п.) — O(1); первая запись после копии
+// копирует только указатели на блоки (O(числа блоков)) и клонирует один блок,
+// в который пишем. Остальные блоки остаются общими между снимками.
+class PixelStore {
+public:
+    void set(QPoint g, QRgb c);
+    void clear() { tiles.clear(); }
+    bool isEmpty() const { return tiles.isEmpty(); }
+    int  tileCount() const { return tiles.size(); }
+
+    // ключ блока, в который попадает клетка g (сдвиг — деление с округлением вниз)
+    static QPoint tileKey(QPoint g) { return QPoint(g.x() >> PixelTile::Shift, g.y() >> PixelTile::Shift); }
+    // блок по ключу или nullptr; по адресу видно, общий ли блок у двух снимков
+    const PixelTile *tile(QPoint key) const;
+
+    // f(QPoint g, QRgb c) для каждого пикселя в прямоугольнике сетки r
+    template <typename F>
+    void forEachIn(const QRect &r, F &&f) const;
+
+private:
+    QHash<QPoint, QSharedDataPointer<PixelTile>> tiles;   // ключ = координаты блока
+
+    template <typename F>
+    static void visitTile(QPoint key, const PixelTile &d, const QRect &r, F &f);
+};
+
+
+inline void PixelStore::set(QPoint g, QRgb c) {
+    const QPoint key = tileKey(g);
+    const int lx = g.x() & (PixelTile::Size - 1);
+    const int ly = g.y() & (PixelTile::Size - 1);
+
+    QSharedDataPointer<PixelTile> &tile = tiles[key];
+    if (!tile) tile = new PixelTile;
+
+    PixelTile *d = tile.data();   // неконстантный доступ клонирует блок, если он общий
+    d->rowMask[ly] |= 1u << lx;
+    d->color[ly * PixelTile::Size + lx] = c;
+}
+
+inline const PixelTile *PixelStore::tile(QPoint key) const {
+    auto it = tiles.constFind(key);
+    return it != tiles.constEnd() ? it.value().constData() : nullptr;
+}
+
+// Обходит только блоки, пересекающие r: если видимых ключей блоков меньше,
+// чем блоков в хранилище, — поиск по каждому ключу, иначе проход по всем
+// блокам с отсечением. Стоимость — O(min(видимые ключи, все блоки)).
+template <typename F>
+void PixelStore::forEachIn(const QRect &r, F &&f) const {
+    if (tiles.isEmpty() || r.isEmpty()) return;
+
+    const int kx0 = r.left() >> PixelTile::Shift, kx1 = r.right()  >> PixelTile::Shift;
+    const int ky0 = r.top()  >> PixelTile::Shift, ky1 = r.bottom() >> PixelTile::Shift;
+
+    if (qint64(kx1 - kx0 + 1) * (ky1 - ky0 + 1) < tiles.size()) {
+        for (int ky = ky0; ky <= ky1; ++ky)
+            for (int kx = kx0; kx <= kx1; ++kx) {
+                auto it = tiles.constFind(QPoint(kx, ky));
+                if (it != tiles.constEnd()) visitTile(it.key(), *it.value().constData(), r, f);
+            }
+        return;
+    }
+
+    for (auto it = tiles.constBegin(); it != tiles.constEnd(); ++it) {
+        const QPoint &k = it.key();
+        if (k.x() < kx0 || k.x() > kx1 || k.y() < ky0 || k.y() > ky1) continue;
+        visitTile(k, *it.value().constData(), r, f);
+    }
+}
+
+template <typename F>
+void PixelStore::visitTile(QPoint key, const PixelTile &d, const QRect &r, F &f) {
+    const int x0 = key.x() * PixelTile::Size;
+    const int y0 = key.y() * PixelTile::Size;
+
+    for (int ly = 0; ly < PixelTile::Size; ++ly) {
+        const int y = y0 + ly;
+        if (y < r.top() || y > r.bottom()) continue;
+
+        for (quint32 m = d.rowMask[ly]; m; m &= m - 1) {
+            const int lx = int(qCountTrailingZeroBits(m));
+            const int x = x0 + lx;
+            if (x < r.left() || x > r.right()) continue;
+            f(QPoint(x, y), d.color[ly * PixelTile::Size + lx]);
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <QPoint>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+// Чистые алгоритмы растеризации без привязки к виджету, цвету и таймерам.
+// Каждый алгоритм вызывает plot(QPoint) для каждой клетки в порядке построения,
+// поэтому результат детерминирован и его можно сравнивать с эталонным набором
+// пикселей независимо от PixelCanvas.
+//
+// skipFirst — не выдавать начальную точку a (она уже нарисована предыдущим
+// сегментом ломаной).
+namespace Raster {
+
+// Область определения. Вычисления ведутся в int, поэтому входы ограничены:
+//  - |x|, |y| концов отрезка и центра окружности <= MaxCoord (2^29 - 1): тогда
+//    dx, dy < 2^30, а 2*dx, ошибка Брезенхема и шаг за конец помещаются в int;
+//  - 0 <= радиус <= MaxRadius (2^28): тогда 3 - 2r, 4*(x - y) и центр ± r
+//    не переполняются.
+// Вне области алгоритмы ничего не рисуют.
+constexpr int MaxCoord  = (1 << 29) - 1;
+constexpr int MaxRadius = 1 << 28;
+
+inline bool inDomain(QPoint p) {
+    return p.x() >= -MaxCoord && p.x() <= MaxCoord && p.y() >= -MaxCoord && p.y() <= MaxCoord;
+}
+
+// ---------- пошаговый алгоритм ----------
+template <typename Plot>
+void lineStep(QPoint a, QPoint b, bool skipFirst, Plot &&plot) {
+    if (!inDomain(a) || !inDomain(b)) return;
+
+    int x1 = a.x(), y1 = a.y();
+    int x2 = b.x(), y2 = b.y();
+
+    int dx = x2 - x1;
+    int dy = y2 - y1;
+
+    // вертикальная линия
+    if (dx == 0) {
+        int y_min = std::min(y1, y2);
+        int y_max = std::max(y1, y2);
+        for (int y = y_min; y <= y_max; ++y) {
+            if (skipFirst && y == a.y()) continue;
+            plot(QPoint(x1, y));
+        }
+        return;
+    }
+
+    float k = static_cast<float>(dy) / static_cast<float>(dx);
+
+    // пологая линия (шагаем по X)
+    if (std::abs(dx) >= std::abs(dy)) {
+        if (x1 > x2) { std::swap(x1, x2); std::swap(y1, y2); dx = x2 - x1; dy = y2 - y1; k = static_cast<float>(dy) / dx; }
+
+        for (int x = x1; x <= x2; ++x) {
+            int y = static_cast<int>(std::round(y1 + k * (x - x1)));
+            if (skipFirst && x == a.x()) continue;   // после swap a может оказаться в конце
+            plot(QPoint(x, y));
+        }
+    }
+    // крутая линия (шагаем по Y)
+    else {
+        if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); dx = x2 - x1; dy = y2 - y1; }
+
+        float inv_k = static_cast<float>(dx) / static_cast<float>(dy);
+        for (int y = y1; y <= y2; ++y) {
+            int x = static_cast<int>(std::round(x1 + inv_k * (y - y1)));
+            if (skipFirst && y == a.y()) continue;
+            plot(QPoint(x, y));
+        }
+    }
+}
+
+// ---------- ЦДА ----------
+template <typename Plot>
+void lineDDA(QPoint a, QPoint b, bool skipFirst, Plot &&plot) {
+    if (!inDomain(a) || !inDomain(b)) return;
+
+    int dx = b.x() - a.x();
+    int dy = b.y() - a.y();
+
+    int L = std::max(std::abs(dx), std::abs(dy));
+    if (L == 0) {
+        if (!skipFirst) plot(a);
+        return;
+    }
+
+    float x_inc = dx / static_cast<float>(L);
+    float y_inc = dy / static_cast<float>(L);
+
+    float x = a.x();
+    float y = a.y();
+
+    for (int i = 0; i <= L; i++) {
+        // последний шаг ставим ровно в b: накопленная ошибка float иначе
+        // может промахнуться мимо конца (особенно на больших координатах)
+        if (i == L)
+            plot(b);
+        else if (i > 0 || !skipFirst)
+            plot(QPoint(std::round(x), std::round(y)));
+        x += x_inc;
+        y += y_inc;
+    }
+}
+
+// ---------- Брезенхем (отрезок) ----------
+template <typename Plot>
+void lineBresenham(QPoint a, QPoint b, bool skipFirst, Plot &&plot) {
+    if (!inDomain(a) || !inDomain(b)) return;
+
+    int x1 = a.x();
+    int y1 = a.y();
+
+    int dx = std::abs(b.x() - x1);
+    int dy = std::abs(b.y() - y1);
+
+    int sx = (x1 < b.x()) ? 1 : -1;
+    int sy = (y1 < b.y()) ? 1 : -1;
+
+    bool steep = dy > dx;
+    if (steep) std::swap(dx, dy);
+
+    int err = 2 * dy - dx;
+
+    for (int i = 0; i <= dx; i++) {
+        if (i > 0 || !skipFirst)
+            plot(QPoint(x1, y1));
+
+        if (err >= 0) {
+            if (steep)
+                x1 += sx;
+            else
+                y1 += sy;
+            err -= 2 * dx;
+        }
+
+        if (steep)
+            y1 += sy;
+        else
+            x1 += sx;
+
+        err += 2 * dy;
+    }
+}
+
+// ---------- Брезенхем (окружность) ----------
+template <typename Plot>
+void circleBresenham(QPoint center, int radius, Plot &&plot) {
+    if (!inDomain(center) || radius < 0 || radius > MaxRadius) return;
+
+    int x0 = center.x();
+    int y0 = center.y();
+
+    int x = 0;
+    int y = radius;
+    int d = 3 - 2 * radius;
+
+    while (x <= y) {
+        // восьмикратная симметрия
+        plot(QPoint(x0 + x, y0 + y));
+        plot(QPoint(x0 - x, y0 + y));
+        plot(QPoint(x0 + x, y0 - y));
+        plot(QPoint(x0 - x, y0 - y));
+        plot(QPoint(x0 + y, y0 + x));
+        plot(QPoint(x0 - y, y0 + x));
+        plot(QPoint(x0 + y, y0 - x));
+        plot(QPoint(x0 - y, y0 - x));
+
+        if (d >= 0) {
+            d += 4 * (x - y) + 10;
+            y--;
+        } else {
+            d += 4 * x + 6;
+        }
+
+        x++;
+    }
+}
+
+// Радиус окружности по центру и точке на ней. Считается в double: в int
+// dx*dx + dy*dy переполняется уже при ~46341 клетке, а в qint64 — при разности
+// координат больше 2^31. Результат ограничен MaxRadius.
+inline int radiusFromPoints(QPoint center, QPoint onCircle) {
+    const double r = std::hypot(double(onCircle.x()) - center.x(), double(onCircle.y()) - center.y());
+    return r >= MaxRadius ? MaxRadius : int(std::lround(r));
+}
+
+} // namespace Raster
@@ -0,0 +1,148 @@
+// Тест хранилища пикселей (pixelstore.h):
+//  1) отрицательные координаты — ключи блоков с округлением вниз, обход
+//     прямоугольников через ноль обоими способами (поиск по ключам и проход
+//     по всем блокам);
+//  2) снимок (копия хранилища) не меняется после записи в оригинал и наоборот;
+//  3) первая запись после копии клонирует только тот блок, в который пишем.
+//
+// Запуск: pixelstore_test
+
+#include "pixelstore.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+
+using Pixels = std::map<std::pair<int, int>, QRgb>;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string &what) {
+    if (ok) return;
+    std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+    ++failures;
+}
+
+static std::string str(QPoint p) {
+    return std::to_string(p.x()) + "," + std::to_string(p.y());
+}
+
+static Pixels collect(const PixelStore &s, QPoint topLeft, QPoint bottomRight) {
+    Pixels out;
+    s.forEachIn(QRect(topLeft, bottomRight), [&](QPoint g, QRgb c) {
+        out[std::make_pair(g.x(), g.y())] = c;
+    });
+    return out;
+}
+
+static Pixels collectAll(const PixelStore &s) {
+    return collect(s, QPoint(-100000, -100000), QPoint(100000, 100000));
+}
+
+static void negativeKeys() {
+    const std::pair<QPoint, QPoint> keys[] = {
+        { QPoint(0, 0),     QPoint(0, 0) },
+        { QPoint(31, 31),   QPoint(0, 0) },
+        { QPoint(32, 0),    QPoint(1, 0) },
+        { QPoint(-1, -1),   QPoint(-1, -1) },
+        { QPoint(-32, -32), QPoint(-1, -1) },
+        { QPoint(-33, 0),   QPoint(-2, 0) },
+        { QPoint(5, -64),   QPoint(0, -2) },
+        { QPoint(-65, 65),  QPoint(-3, 2) },
+    };
+
+    PixelStore s;
+    Pixels expected;
+    QRgb c = 1;
+    for (const auto &k : keys) {
+        check(PixelStore::tileKey(k.first) == k.second, "tileKey " + str(k.first));
+        s.set(k.first, c);
+        expected[std::make_pair(k.first.x(), k.first.y())] = c++;
+    }
+    check(s.tileCount() == 6, "tileCount " + std::to_string(s.tileCount()) + " вместо 6");
+    check(collectAll(s) == expected, "все пиксели (проход по блокам)");
+
+    // маленькие прямоугольники: видимых ключей меньше, чем блоков, — поиск по ключам
+    for (const auto &k : keys) {
+        const Pixels one = collect(s, k.first, k.first);
+        check(one.size() == 1 && one.begin()->second == expected[std::make_pair(k.first.x(), k.first.y())],
+              "пиксель " + str(k.first));
+    }
+    const Pixels aroundZero = collect(s, QPoint(-1, -1), QPoint(0, 0));
+    check(aroundZero.size() == 2 && aroundZero.count(std::make_pair(-1, -1)) && aroundZero.count(std::make_pair(0, 0)),
+          "прямоугольник через ноль");
+    check(collect(s, QPoint(-31, -31), QPoint(-2, -2)).empty(), "пустая часть отрицательного блока");
+
+    // отрицательная полуплоскость целиком
+    Pixels negative;
+    for (const auto &p : expected)
+        if (p.first.first < 0) negative.insert(p);
+    check(collect(s, QPoint(-100000, -100000), QPoint(-1, 100000)) == negative, "x < 0");
+}
+
+static void snapshotIsolation() {
+    PixelStore s;
+    for (int i = -40; i <= 40; i += 8) s.set(QPoint(i, -i), QRgb(100 + i));
+    const Pixels before = collectAll(s);
+
+    const PixelStore snapshot = s;
+    s.set(QPoint(0, 0), 0xff0000);       // перезапись существующего пикселя
+    s.set(QPoint(1, 1), 0x00ff00);       // новый пиксель в существующем блоке
+    s.set(QPoint(-500, -500), 0x0000ff); // новый блок
+
+    check(collectAll(snapshot) == before, "снимок изменился после записи в оригинал");
+    const Pixels after = collectAll(s);
+    check(after.size() == before.size() + 2 && after.at(std::make_pair(0, 0)) == 0xff0000,
+          "запись в оригинал");
+
+    PixelStore copy = snapshot;
+    copy.set(QPoint(-8, 8), 0x123456);
+    check(collectAll(snapshot) == before, "снимок изменился после записи в свою копию");
+    check(collectAll(s) == after, "оригинал изменился после записи в копию снимка");
+
+    s.clear();
+    check(s.isEmpty() && collectAll(snapshot) == before, "clear оригинала задел снимок");
+}
+
+static void cloneOnlyTouchedTile() {
+    PixelStore s;
+    const QPoint cells[] = { QPoint(0, 0), QPoint(40, 3), QPoint(-5, -70), QPoint(-100, 100) };
+    for (const QPoint &g : cells) s.set(g, 1);
+
+    PixelStore snapshot = s;
+    for (const QPoint &g : cells) {
+        const QPoint key = PixelStore::tileKey(g);
+        check(s.tile(key) && s.tile(key) == snapshot.tile(key), "после копии блок " + str(key) + " общий");
+    }
+
+    const QPoint touched = PixelStore::tileKey(QPoint(-5, -70));
+    s.set(QPoint(-6, -70), 2);
+    for (const QPoint &g : cells) {
+        const QPoint key = PixelStore::tileKey(g);
+        if (key == touched)
+            check(s.tile(key) != snapshot.tile(key), "блок " + str(key) + " не склонирован при записи");
+        else
+            check(s.tile(key) == snapshot.tile(key), "блок " + str(key) + " склонирован без записи");
+    }
+
+    // повторная запись в уже собственный блок больше не клонирует
+    const PixelTile *own = s.tile(touched);
+    s.set(QPoint(-7, -70), 3);
+    check(s.tile(touched) == own, "повторная запись склонировала блок ещё раз");
+
+    // новый блок появляется только в том хранилище, куда писали
+    s.set(QPoint(1000, 1000), 4);
+    check(s.tile(PixelStore::tileKey(QPoint(1000, 1000))) && !snapshot.tile(PixelStore::tileKey(QPoint(1000, 1000))),
+          "новый блок попал в снимок");
+    check(snapshot.tileCount() == 4 && s.tileCount() == 5, "число блоков");
+}
+
+int main() {
+    negativeKeys();
+    cloneOnlyTouchedTile();
+    snapshotIsolation();
+
+    std::printf("%s: ошибок %d\n", failures ? "FAIL" : "OK", failures);
+    return failures ? 1 : 0;
+}
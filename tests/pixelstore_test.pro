@@ -0,0 +1,22 @@
+# Тест хранилища пикселей (pixelstore.h): снимки copy-on-write, ключи блоков.
+# Сборка и запуск вместе с остальными тестами:
+#   cd tests && qmake && make check
+
+QT       = core gui     # QRgb
+CONFIG  += console c++17 testcase
+CONFIG  -= app_bundle
+
+TARGET = pixelstore_test
+
+INCLUDEPATH += ..
+
+HEADERS += \
+    ../pixelstore.h
+
+SOURCES += \
+    pixelstore_test.cpp
+
+!msvc {
+    QMAKE_CXXFLAGS += -fsanitize=address,undefined -fno-sanitize-recover=undefined -fno-omit-frame-pointer
+    QMAKE_LFLAGS   += -fsanitize=address,undefined
+}
@@ -0,0 +1,585 @@
+// Регрессионный тест алгоритмов растеризации:
+//  1) эталонные наборы пикселей (golden/raster_golden.txt) — все октанты,
+//     вырожденные случаи (dx == 0, L == 0, радиус 0, ветка x1 > x2 в lineStep);
+//  2) полный перебор отрезков с концами в [-12, 12]^2 и окружностей — сравнение
+//     с исходной (до выноса в rasterizer.h) реализацией и дайджест из эталона;
+//  3) фаззинг со случайными, в том числе большими, координатами — проверка
+//     инвариантов; сборка с -fsanitize=address,undefined ловит UB;
+//  4) весь диапазон int: вне области определения (Raster::MaxCoord,
+//     Raster::MaxRadius) алгоритмы ничего не рисуют, внутри — отрезки длиной
+//     до 2^30 клеток и окружности радиусом до 2^28; radiusFromPoints.
+//
+// Запуск: raster_golden [--update-golden] [--seed N] [--iterations N]
+
+#include "rasterizer.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Pixels = std::vector<QPoint>;
+
+static int failures = 0;
+
+static void fail(const std::string &what) {
+    if (failures < 20) std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+    ++failures;
+}
+
+static std::string str(QPoint p) {
+    return std::to_string(p.x()) + "," + std::to_string(p.y());
+}
+
+static std::string str(const Pixels &v) {
+    std::string s;
+    for (const QPoint &p : v) s += (s.empty() ? "" : " ") + str(p);
+    return s;
+}
+
+// ---------- запуск алгоритма по имени ----------
+// для отрезков args = x1 y1 x2 y2, для окружности — cx cy r
+
+static const char *const Algorithms[] = { "step", "dda", "bresenham", "circle" };
+
+// отрезок алгоритмом Algorithms[k] (k = 0..2) в переиспользуемый буфер:
+// в циклах перебора и фаззинга это на порядки ускоряет прогон под ASan
+static void plotLine(int k, QPoint a, QPoint b, bool skipFirst, Pixels &out) {
+    out.clear();
+    auto plot = [&](QPoint p) { out.push_back(p); };
+    if (k == 0)      Raster::lineStep(a, b, skipFirst, plot);
+    else if (k == 1) Raster::lineDDA(a, b, skipFirst, plot);
+    else             Raster::lineBresenham(a, b, skipFirst, plot);
+}
+
+static void plotCircle(QPoint c, int r, Pixels &out) {
+    out.clear();
+    Raster::circleBresenham(c, r, [&](QPoint p) { out.push_back(p); });
+}
+
+static Pixels run(const std::string &alg, const std::vector<int> &args) {
+    Pixels v;
+    if (alg == "circle") {
+        plotCircle(QPoint(args[0], args[1]), args[2], v);
+        return v;
+    }
+    for (int k = 0; k < 3; ++k)
+        if (alg == Algorithms[k]) plotLine(k, QPoint(args[0], args[1]), QPoint(args[2], args[3]), false, v);
+    return v;
+}
+
+// ---------- исходная реализация (PixelCanvas до выноса в rasterizer.h) ----------
+
+namespace Reference {
+
+static void lineStep(QPoint a, QPoint b, Pixels &o) {
+    o.clear();
+    int x1 = a.x(), y1 = a.y(), x2 = b.x(), y2 = b.y();
+    int dx = x2 - x1, dy = y2 - y1;
+    if (dx == 0) {
+        for (int y = std::min(y1, y2); y <= std::max(y1, y2); ++y) o.push_back(QPoint(x1, y));
+        return;
+    }
+    float k = static_cast<float>(dy) / static_cast<float>(dx);
+    if (std::abs(dx) >= std::abs(dy)) {
+        if (x1 > x2) { std::swap(x1, x2); std::swap(y1, y2); dx = x2 - x1; dy = y2 - y1; k = static_cast<float>(dy) / dx; }
+        for (int x = x1; x <= x2; ++x)
+            o.push_back(QPoint(x, static_cast<int>(std::round(y1 + k * (x - x1)))));
+    } else {
+        if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); dx = x2 - x1; dy = y2 - y1; }
+        float inv_k = static_cast<float>(dx) / static_cast<float>(dy);
+        for (int y = y1; y <= y2; ++y)
+            o.push_back(QPoint(static_cast<int>(std::round(x1 + inv_k * (y - y1))), y));
+    }
+}
+
+static void lineDDA(QPoint a, QPoint b, Pixels &o) {
+    o.clear();
+    int dx = b.x() - a.x(), dy = b.y() - a.y();
+    int L = std::max(std::abs(dx), std::abs(dy));
+    if (L == 0) { o.push_back(a); return; }
+    float x_inc = dx / static_cast<float>(L), y_inc = dy / static_cast<float>(L);
+    float x = a.x(), y = a.y();
+    for (int i = 0; i <= L; i++) {
+        o.push_back(QPoint(int(std::round(x)), int(std::round(y))));
+        x += x_inc;
+        y += y_inc;
+    }
+}
+
+static void lineBresenham(QPoint a, QPoint b, Pixels &o) {
+    o.clear();
+    int x1 = a.x(), y1 = a.y();
+    int dx = std::abs(b.x() - x1), dy = std::abs(b.y() - y1);
+    int sx = (x1 < b.x()) ? 1 : -1, sy = (y1 < b.y()) ? 1 : -1;
+    bool steep = dy > dx;
+    if (steep) std::swap(dx, dy);
+    int err = 2 * dy - dx;
+    for (int i = 0; i <= dx; i++) {
+        o.push_back(QPoint(x1, y1));
+        if (err >= 0) { if (steep) x1 += sx; else y1 += sy; err -= 2 * dx; }
+        if (steep) y1 += sy; else x1 += sx;
+        err += 2 * dy;
+    }
+}
+
+static void circle(QPoint c, int r, Pixels &o) {
+    o.clear();
+    int x = 0, y = r, d = 3 - 2 * r;
+    while (x <= y) {
+        for (QPoint p : { QPoint( x,  y), QPoint(-x,  y), QPoint( x, -y), QPoint(-x, -y),
+                          QPoint( y,  x), QPoint(-y,  x), QPoint( y, -x), QPoint(-y, -x) })
+            o.push_back(QPoint(c.x() + p.x(), c.y() + p.y()));
+        if (d >= 0) { d += 4 * (x - y) + 10; y--; } else d += 4 * x + 6;
+        x++;
+    }
+}
+
+} // namespace Reference
+
+// ---------- полный перебор малых координат ----------
+
+static const int GridMin = -12, GridMax = 12;
+
+// FNV-1a по всем точкам перебора — компактный эталон для ~390 тыс. отрезков
+struct Digest {
+    std::uint64_t h = 1469598103934665603ull;
+    void add(int v) {
+        for (int i = 0; i < 4; ++i) { h ^= std::uint8_t(unsigned(v) >> (8 * i)); h *= 1099511628211ull; }
+    }
+    void add(const Pixels &v) { add(int(v.size())); for (const QPoint &p : v) { add(p.x()); add(p.y()); } }
+    std::string hex() const { char buf[17]; std::snprintf(buf, sizeof buf, "%016llx", (unsigned long long)h); return buf; }
+};
+
+static std::map<std::string, std::string> exhaustiveGrid() {
+    std::map<std::string, Digest> digests;
+    Pixels full, ref, skipped, expected;   // буферы переиспользуются
+    int ddaEndpointDiffs = 0;
+
+    for (int x1 = GridMin; x1 <= GridMax; ++x1)
+    for (int y1 = GridMin; y1 <= GridMax; ++y1)
+    for (int x2 = GridMin; x2 <= GridMax; ++x2)
+    for (int y2 = GridMin; y2 <= GridMax; ++y2) {
+        const QPoint a(x1, y1), b(x2, y2);
+        auto seg = [&] { return str(a) + " -> " + str(b); };
+
+        for (int k = 0; k < 3; ++k) {
+            const char *alg = Algorithms[k];
+            plotLine(k, a, b, false, full);
+            digests[alg].add(full);
+
+            if (k == 0)      Reference::lineStep(a, b, ref);
+            else if (k == 1) Reference::lineDDA(a, b, ref);
+            else             Reference::lineBresenham(a, b, ref);
+            // Единственное допустимое отличие от исходной реализации: ЦДА ставит
+            // последнюю точку ровно в b (исходный мог промахнуться из-за float).
+            // Всё остальное, включая остальные точки ЦДА, должно совпадать.
+            const bool ddaEndpoint = k == 1 && !ref.empty() && !(ref.back() == b);
+            if (ddaEndpoint) {
+                ++ddaEndpointDiffs;
+                if (full.size() != ref.size() || !(full.back() == b) ||
+                    !std::equal(full.begin(), full.end() - 1, ref.begin()))
+                    fail("dda: отличие от исходной реализации не только в конечной точке: " + seg());
+            } else if (full != ref) {
+                fail(std::string(alg) + " отличается от исходной реализации: " + seg());
+            }
+
+            // skipFirst = тот же растр без начальной точки
+            expected.clear();
+            if (!(a == b))
+                for (const QPoint &p : full) if (!(p == a)) expected.push_back(p);
+            plotLine(k, a, b, true, skipped);
+            if (skipped != expected) fail(std::string(alg) + " skipFirst: " + seg());
+        }
+    }
+
+    for (int cx = -3; cx <= 3; ++cx)
+    for (int cy = -3; cy <= 3; ++cy)
+    for (int r = 0; r <= GridMax; ++r) {
+        plotCircle(QPoint(cx, cy), r, full);
+        digests["circle"].add(full);
+        Reference::circle(QPoint(cx, cy), r, ref);
+        if (full != ref)
+            fail("circle отличается от исходной реализации: " + str(QPoint(cx, cy)) + " r=" + std::to_string(r));
+    }
+
+    std::printf("полный перебор: ЦДА исправил конечную точку в %d отрезках\n", ddaEndpointDiffs);
+
+    std::map<std::string, std::string> out;
+    for (auto &kv : digests) out[kv.first] = kv.second.hex();
+    return out;
+}
+
+// ---------- эталонные наборы ----------
+
+// Отрезки: все восемь октантов, оси и диагонали в обе стороны, L == 0,
+// ветка x1 > x2 (обход справа налево) и крутые отрезки сверху вниз.
+static std::vector<std::vector<int>> goldenLines() {
+    std::vector<std::vector<int>> v;
+    const int oct[][2] = { {7,3}, {3,7}, {-3,7}, {-7,3}, {-7,-3}, {-3,-7}, {3,-7}, {7,-3} };
+    for (auto &d : oct) v.push_back({ 0, 0, d[0], d[1] });
+    for (auto &d : oct) v.push_back({ 2, -1, 2 + 2 * d[0], -1 + 5 * d[1] / 3 });
+    v.push_back({ 4, -5, 4, 6 });     // dx == 0, вверх
+    v.push_back({ 4, 6, 4, -5 });     // dx == 0, вниз
+    v.push_back({ -6, 2, 9, 2 });     // dy == 0
+    v.push_back({ 9, 2, -6, 2 });     // dy == 0, справа налево
+    v.push_back({ 0, 0, 6, 6 });      // диагонали
+    v.push_back({ 6, -6, 0, 0 });
+    v.push_back({ -5, 5, 0, 0 });
+    v.push_back({ 3, 3, 3, 3 });      // L == 0
+    v.push_back({ 5, 1, -4, -2 });    // x1 > x2, пологий
+    v.push_back({ 11, 4, -11, -3 });
+    v.push_back({ 2, 9, -1, -8 });    // y1 > y2, крутой
+    v.push_back({ -3, 1, 4, 2 });     // k близко к 0: граница округления
+    v.push_back({ 0, 0, 10, 5 });     // k = 0.5: округление половин
+    v.push_back({ 0, 0, 5, 10 });
+    return v;
+}
+
+static std::vector<std::vector<int>> goldenCircles() {
+    std::vector<std::vector<int>> v;
+    for (int r : { 0, 1, 2, 3, 5, 8, 13 }) v.push_back({ 0, 0, r });
+    v.push_back({ -3, 4, 0 });        // радиус 0 вне начала координат
+    v.push_back({ -3, 4, 6 });
+    return v;
+}
+
+static std::string caseKey(const std::string &alg, const std::vector<int> &args) {
+    std::string s = alg;
+    for (int a : args) s += " " + std::to_string(a);
+    return s;
+}
+
+static std::string goldenText(const std::map<std::string, std::string> &digests) {
+    std::ostringstream out;
+    out << "# Эталонные наборы пикселей для rasterizer.h (порядок построения важен).\n"
+           "# Строка: <алгоритм> <x1 y1 x2 y2 | cx cy r> : <x,y ...>\n"
+           "# digest — FNV-1a по полному перебору отрезков [-12,12]^2 и окружностей.\n"
+           "# Перегенерация: raster_golden --update-golden\n";
+    for (int k = 0; k < 3; ++k)
+        for (const auto &args : goldenLines())
+            out << caseKey(Algorithms[k], args) << " : " << str(run(Algorithms[k], args)) << "\n";
+    for (const auto &args : goldenCircles())
+        out << caseKey("circle", args) << " : " << str(run("circle", args)) << "\n";
+    for (const auto &kv : digests)
+        out << "digest " << kv.first << " " << kv.second << "\n";
+    return out.str();
+}
+
+static void checkGolden(const std::map<std::string, std::string> &digests) {
+    std::ifstream in(GOLDEN_FILE);
+    if (!in) { fail(std::string("нет файла эталонов ") + GOLDEN_FILE); return; }
+
+    int cases = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ls(line);
+        std::string alg;
+        ls >> alg;
+
+        if (alg == "digest") {
+            std::string name, hex;
+            ls >> name >> hex;
+            auto it = digests.find(name);
+            if (it == digests.end() || it->second != hex)
+                fail("дайджест полного перебора " + name + ": " +
+                     (it == digests.end() ? std::string("нет") : it->second) + ", эталон " + hex);
+            continue;
+        }
+
+        const size_t colon = line.find(" : ");
+        std::istringstream head(line.substr(0, colon));
+        head >> alg;
+        std::vector<int> args;
+        for (int v; head >> v;) args.push_back(v);
+        const std::string expected = colon == std::string::npos ? "" : line.substr(colon + 3);
+
+        const std::string got = str(run(alg, args));
+        if (got != expected) fail(caseKey(alg, args) + ":\n  ожидалось " + expected + "\n  получено  " + got);
+        ++cases;
+    }
+    if (cases == 0) fail("в файле эталонов нет ни одного набора");
+    std::printf("эталонные наборы: %d\n", cases);
+}
+
+// ---------- фаззинг ----------
+// Проверяемые инварианты отрезка a -> b:
+//   - ровно L + 1 точек (L = max(|dx|, |dy|)), первая — a, последняя — b
+//     (у пошагового — a и b присутствуют, порядок зависит от направления);
+//   - 8-связность: соседние точки отличаются не более чем на 1 по каждой оси.
+// Точность float ограничена, поэтому для пошагового и ЦДА инварианты
+// проверяются только там, где они выполняются (см. README, раздел ЦДА):
+//   ЦДА связен до ±4096 на отрезках до 2000 клеток и до ±524288 на коротких.
+// На координатах до ±1e8 для всех алгоритмов проверяется число точек, а
+// санитайзеры — отсутствие UB.
+
+static bool connected(const Pixels &v) {
+    for (size_t i = 1; i < v.size(); ++i)
+        if (std::abs(v[i].x() - v[i-1].x()) > 1 || std::abs(v[i].y() - v[i-1].y()) > 1) return false;
+    return true;
+}
+
+static bool contains(const Pixels &v, QPoint p) {
+    for (const QPoint &q : v) if (q == p) return true;
+    return false;
+}
+
+struct FuzzTier {
+    const char *name;
+    int range;           // |координата| начала
+    int maxLen;          // |dx|, |dy| не больше
+    bool floatExact;     // пошаговый/ЦДА: концы и 8-связность
+    bool ddaConnected;   // ЦДА: 8-связность
+};
+
+static void fuzz(unsigned seed, int iterations) {
+    const FuzzTier tiers[] = {
+        { "±4096, длина до 2000",  4096,      2000, true,  true  },
+        { "±524288, длина до 30",  524288,    30,   true,  true  },
+        { "±1e6, длина до 2000",   1000000,   2000, true,  false },
+        { "±1e8, длина до 2000",   100000000, 2000, false, false },
+    };
+
+    std::mt19937 rng(seed);
+    Pixels v;
+    for (const FuzzTier &t : tiers) {
+        std::uniform_int_distribution<int> pos(-t.range, t.range), len(-t.maxLen, t.maxLen);
+        const int before = failures;
+
+        for (int n = 0; n < iterations; ++n) {
+            const QPoint a(pos(rng), pos(rng));
+            const QPoint b(a.x() + len(rng), a.y() + len(rng));
+            const size_t points = size_t(std::max(std::abs(b.x() - a.x()), std::abs(b.y() - a.y()))) + 1;
+            auto seg = [&] { return std::string(t.name) + ": " + str(a) + " -> " + str(b); };
+
+            for (int k = 0; k < 3; ++k) {
+                const std::string alg = Algorithms[k];
+                plotLine(k, a, b, false, v);
+                if (v.size() != points) { fail(alg + " число точек " + seg()); continue; }
+
+                const bool exact = alg == "bresenham" || t.floatExact;
+                if (exact) {
+                    if (alg == "step" ? !contains(v, a) || !contains(v, b)
+                                      : !(v.front() == a) || !(v.back() == b))
+                        fail(alg + " концы " + seg());
+                }
+                const bool mustConnect = alg == "bresenham" || alg == "step" ? exact : t.ddaConnected;
+                if (mustConnect && !connected(v)) fail(alg + " 8-связность " + seg());
+            }
+        }
+
+        // окружности: каждая точка не дальше 1 клетки от идеальной окружности
+        std::uniform_int_distribution<int> radius(0, t.maxLen);
+        for (int n = 0; n < iterations / 10; ++n) {
+            const QPoint c(pos(rng), pos(rng));
+            const int r = radius(rng);
+            plotCircle(c, r, v);
+            for (const QPoint &p : v) {
+                const double dx = double(p.x()) - c.x(), dy = double(p.y()) - c.y();
+                if (std::abs(std::sqrt(dx * dx + dy * dy) - r) >= 1.0) {
+                    fail(std::string("circle радиус ") + t.name + ": " + str(c) + " r=" + std::to_string(r));
+                    break;
+                }
+            }
+        }
+
+        std::printf("фаззинг %-22s %s\n", t.name, failures == before ? "ok" : "FAIL");
+    }
+}
+
+// ---------- весь диапазон int ----------
+// Отрезки длиной до 2^30 клеток в память не помещаются: Walk проверяет поток
+// точек без хранения и, дойдя до limit, останавливает алгоритм исключением.
+
+struct Stop {};
+
+struct Walk {
+    size_t limit = SIZE_MAX;
+    size_t count = 0;
+    QPoint first, last;
+    bool connected = true;
+
+    void operator()(QPoint p) {
+        if (count == 0) first = p;
+        else if (std::llabs(qint64(p.x()) - last.x()) > 1 || std::llabs(qint64(p.y()) - last.y()) > 1) connected = false;
+        last = p;
+        if (++count == limit) throw Stop();
+    }
+};
+
+static Walk walkLine(int k, QPoint a, QPoint b, size_t limit) {
+    Walk w;
+    w.limit = limit;
+    try {
+        if (k == 0)      Raster::lineStep(a, b, false, w);
+        else if (k == 1) Raster::lineDDA(a, b, false, w);
+        else             Raster::lineBresenham(a, b, false, w);
+    } catch (const Stop &) {}
+    return w;
+}
+
+// число точек окружности (не больше limit) и все ли они не дальше 1 клетки
+// от идеальной окружности
+static size_t walkCircle(QPoint c, int r, size_t limit, bool &onCircle) {
+    size_t count = 0;
+    onCircle = true;
+    try {
+        Raster::circleBresenham(c, r, [&](QPoint p) {
+            const double dx = double(p.x()) - c.x(), dy = double(p.y()) - c.y();
+            if (std::abs(std::sqrt(dx * dx + dy * dy) - r) >= 1.0) onCircle = false;
+            if (++count == limit) throw Stop();
+        });
+    } catch (const Stop &) {}
+    return count;
+}
+
+static qint64 span(QPoint a, QPoint b) {
+    return std::max(std::llabs(qint64(b.x()) - a.x()), std::llabs(qint64(b.y()) - a.y()));
+}
+
+static void radiusCases() {
+    using Raster::MaxRadius;
+    struct Case { QPoint c, p; int r; };
+    const Case cases[] = {
+        { QPoint(0, 0),             QPoint(0, 0),             0 },
+        { QPoint(0, 0),             QPoint(3, 4),             5 },
+        { QPoint(-5, -5),           QPoint(-5, 7),            12 },
+        { QPoint(0, 0),             QPoint(3, 3),             4 },
+        { QPoint(0, 0),             QPoint(46341, 0),         46341 },   // 46341^2 > INT_MAX
+        { QPoint(0, 0),             QPoint(46341, 46341),     65536 },
+        { QPoint(-1000000, 0),      QPoint(1000000, 0),       2000000 },
+        { QPoint(0, 0),             QPoint(MaxRadius - 1, 0), MaxRadius - 1 },
+        { QPoint(0, 0),             QPoint(MaxRadius, 0),     MaxRadius },
+        { QPoint(0, 0),             QPoint(MaxRadius, 1),     MaxRadius },
+        { QPoint(INT_MIN, 0),       QPoint(INT_MAX, 0),       MaxRadius }, // разность > 2^31
+        { QPoint(INT_MIN, INT_MIN), QPoint(INT_MAX, INT_MAX), MaxRadius }, // dx*dx > 2^63
+        { QPoint(INT_MAX, INT_MIN), QPoint(INT_MIN, INT_MAX), MaxRadius },
+    };
+    for (const Case &t : cases) {
+        const int r = Raster::radiusFromPoints(t.c, t.p);
+        if (r != t.r)
+            fail("radiusFromPoints " + str(t.c) + " " + str(t.p) + ": " + std::to_string(r) + " вместо " + std::to_string(t.r));
+    }
+}
+
+static void fuzzFullRange(unsigned seed, int iterations) {
+    using Raster::MaxCoord;
+    using Raster::MaxRadius;
+    const int before = failures;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> any(INT_MIN, INT_MAX), inside(-MaxCoord, MaxCoord), radius(0, MaxRadius);
+    auto seg = [](QPoint a, QPoint b) { return str(a) + " -> " + str(b); };
+
+    radiusCases();
+
+    // вне области: ни одной точки
+    const int outsideRadius[] = { -1, INT_MIN, MaxRadius + 1, INT_MAX };
+    for (int n = 0; n < iterations; ++n) {
+        const QPoint a(any(rng), any(rng)), b(any(rng), any(rng));
+        if (!Raster::inDomain(a) || !Raster::inDomain(b)) {
+            for (int k = 0; k < 3; ++k)
+                if (walkLine(k, a, b, 1).count != 0) fail(std::string(Algorithms[k]) + " вне области " + seg(a, b));
+        }
+        bool onCircle;
+        if (!Raster::inDomain(a) && walkCircle(a, radius(rng), 1, onCircle) != 0)
+            fail("circle вне области " + str(a));
+        const QPoint c(inside(rng), inside(rng));
+        if (walkCircle(c, outsideRadius[n % 4], 1, onCircle) != 0)
+            fail("circle радиус " + std::to_string(outsideRadius[n % 4]) + " вне области");
+    }
+
+    // длинные отрезки внутри области — начало каждого отрезка в обе стороны.
+    // Пошаговый и ЦДА считают во float, на таких координатах точен только
+    // Брезенхем; для остальных проверяется число точек (и отсутствие UB).
+    const size_t prefix = 1024;
+    const QPoint corners[][2] = {
+        { QPoint(-MaxCoord, -MaxCoord), QPoint(MaxCoord, MaxCoord) },
+        { QPoint(-MaxCoord, MaxCoord),  QPoint(MaxCoord, -MaxCoord) },
+        { QPoint(-MaxCoord, 0),         QPoint(MaxCoord, 1) },
+        { QPoint(0, -MaxCoord),         QPoint(0, MaxCoord) },
+    };
+    for (int n = 0; n < iterations / 10 + 4; ++n) {
+        const bool corner = n < 4;
+        const QPoint a = corner ? corners[n][0] : QPoint(inside(rng), inside(rng));
+        const QPoint b = corner ? corners[n][1] : QPoint(inside(rng), inside(rng));
+        const size_t points = size_t(std::min<qint64>(span(a, b) + 1, prefix));
+        for (int dir = 0; dir < 2; ++dir) {
+            const QPoint from = dir ? b : a, to = dir ? a : b;
+            for (int k = 0; k < 3; ++k) {
+                const Walk w = walkLine(k, from, to, prefix);
+                if (w.count != points) { fail(std::string(Algorithms[k]) + " число точек " + seg(from, to)); continue; }
+                if (k == 2 && (!(w.first == from) || !w.connected)) fail("bresenham начало/8-связность " + seg(from, to));
+            }
+        }
+    }
+
+    // отрезки до 2^20 клеток у края области — целиком
+    std::uniform_int_distribution<int> edge(MaxCoord - (1 << 20), MaxCoord), len(-(1 << 20), 1 << 20);
+    for (int n = 0; n < std::max(iterations / 1000, 4); ++n) {
+        const int sx = n & 1 ? 1 : -1, sy = n & 2 ? 1 : -1;
+        const QPoint a(sx * edge(rng), sy * edge(rng));
+        QPoint b(a.x() + len(rng), a.y() + len(rng));
+        b = QPoint(std::max(-MaxCoord, std::min(MaxCoord, b.x())), std::max(-MaxCoord, std::min(MaxCoord, b.y())));
+        const size_t points = size_t(span(a, b) + 1);
+        for (int k = 0; k < 3; ++k) {
+            const Walk w = walkLine(k, a, b, SIZE_MAX);
+            if (w.count != points) { fail(std::string(Algorithms[k]) + " число точек " + seg(a, b)); continue; }
+            if (k == 1 && !(w.last == b)) fail("dda конец " + seg(a, b));
+            if (k == 2 && (!(w.first == a) || !(w.last == b) || !w.connected)) fail("bresenham концы/8-связность " + seg(a, b));
+        }
+    }
+
+    // окружности: радиус до MaxRadius — первые точки, до 2^16 у края области — целиком
+    bool onCircle;
+    for (int n = 0; n < iterations / 10 + 2; ++n) {
+        const QPoint c = n == 0 ? QPoint(MaxCoord, MaxCoord) : n == 1 ? QPoint(-MaxCoord, -MaxCoord) : QPoint(inside(rng), inside(rng));
+        const int r = n < 2 ? MaxRadius : radius(rng);
+        if (walkCircle(c, r, 8 * prefix, onCircle) != 8 * prefix || !onCircle)
+            fail("circle " + str(c) + " r=" + std::to_string(r));
+    }
+    std::uniform_int_distribution<int> smallRadius(0, 1 << 16);
+    for (int n = 0; n < std::max(iterations / 1000, 4); ++n) {
+        const QPoint c((n & 1 ? 1 : -1) * edge(rng), (n & 2 ? 1 : -1) * edge(rng));
+        const int r = smallRadius(rng);
+        if (walkCircle(c, r, SIZE_MAX, onCircle) == 0 || !onCircle)
+            fail("circle " + str(c) + " r=" + std::to_string(r));
+    }
+
+    std::printf("фаззинг %-22s %s\n", "весь диапазон int", failures == before ? "ok" : "FAIL");
+}
+
+int main(int argc, char *argv[]) {
+    bool update = false;
+    unsigned seed = 20261018u;
+    int iterations = 20000;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--update-golden") update = true;
+        else if (arg == "--seed" && i + 1 < argc) seed = unsigned(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--iterations" && i + 1 < argc) iterations = std::atoi(argv[++i]);
+    }
+
+    const std::map<std::string, std::string> digests = exhaustiveGrid();
+
+    if (update) {
+        std::ofstream(GOLDEN_FILE) << goldenText(digests);
+        std::printf("эталоны записаны в %s\n", GOLDEN_FILE);
+        return failures ? 1 : 0;
+    }
+
+    checkGolden(digests);
+    fuzz(seed, iterations);
+    fuzzFullRange(seed, iterations);
+
+    std::printf("%s: ошибок %d (seed %u, итераций %d)\n", failures ? "FAIL" : "OK", failures, seed, iterations);
+    return failures ? 1 : 0;
+}
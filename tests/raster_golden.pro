@@ -0,0 +1,27 @@
+# Регрессионные тесты алгоритмов растеризации (rasterizer.h).
+# Сборка и запуск:
+#   cd tests && qmake && make check   (tests.pro собирает все тесты)
+# Перегенерировать эталоны (после осознанного изменения алгоритма):
+#   ./raster_golden --update-golden
+
+QT       = core
+CONFIG  += console c++17 testcase
+CONFIG  -= app_bundle
+
+TARGET = raster_golden
+
+INCLUDEPATH += ..
+
+HEADERS += \
+    ../rasterizer.h
+
+SOURCES += \
+    raster_golden.cpp
+
+DEFINES += GOLDEN_FILE=\\\"$$PWD/golden/raster_golden.txt\\\"
+
+# фаззинг гоняется под санитайзерами: любое UB/выход за границы — падение теста
+!msvc {
+    QMAKE_CXXFLAGS += -fsanitize=address,undefined -fno-sanitize-recover=undefined -fno-omit-frame-pointer
+    QMAKE_LFLAGS   += -fsanitize=address,undefined
+}
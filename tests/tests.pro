@@ -0,0 +1,11 @@
+# Все тесты:
+#   cd tests && qmake && make check
+
+TEMPLATE = subdirs
+
+raster_golden.file   = raster_golden.pro
+pixelstore_test.file = pixelstore_test.pro
+
+SUBDIRS += \
+    raster_golden \
+    pixelstore_test